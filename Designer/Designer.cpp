@@ -0,0 +1,10 @@
+//
+//  Designer.cpp
+//  Designer
+//
+//  Builds the Designer runtime library. Scenario files that include only DesignerScenario.h link against
+//  this instead of defining DESIGNER_GENERATE_GLOBALS themselves.
+//
+
+#define DESIGNER_GENERATE_GLOBALS
+#include "Designer.h"
@@ -8,14 +8,37 @@
 #ifndef Designer_Designer_h
 #define Designer_Designer_h
 
+#include <atomic>
 #include <iostream>
 #include <locale>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <typeinfo>
 #include <vector>
 
+#if defined(__GNUC__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#include "DesignerScenario.h"
+
+// Asynchronous scenarios need C++20 coroutines and are compiled out for earlier language standards.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define DESIGNER_COROUTINES_ENABLED
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <thread>
+#endif
+
 namespace MuddledManaged
 {
     namespace Designer
@@ -95,6 +118,108 @@ namespace MuddledManaged
             }
         };
         
+        class ThrowsVerificationException : public VerificationException
+        {
+        public:
+            ThrowsVerificationException (const std::string & expectedValue, const std::string & actualValue)
+            : mExpectedValue(expectedValue), mActualValue(actualValue)
+            {
+                initialize();
+            }
+            
+            static std::string typeName (const std::type_info & type)
+            {
+#if defined(__GNUC__)
+                int status = 0;
+                char * demangledName = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+                if (demangledName != nullptr)
+                {
+                    std::string result = demangledName;
+                    std::free(demangledName);
+                    if (status == 0)
+                    {
+                        return result;
+                    }
+                }
+#endif
+                return type.name();
+            }
+            
+            // Describes the exception currently being handled. Only call this from inside a catch clause.
+            static std::string currentExceptionDescription ()
+            {
+                std::string description = "exception";
+#if defined(__GNUC__)
+                const std::type_info * type = abi::__cxa_current_exception_type();
+                if (type != nullptr)
+                {
+                    description += " of type " + typeName(*type);
+                }
+#endif
+                try
+                {
+                    throw;
+                }
+                catch (const std::exception & ex)
+                {
+                    description += " with message: " + std::string(ex.what());
+                }
+                catch (...)
+                {
+                }
+                return description;
+            }
+            
+            std::string expectedValue () const
+            {
+                return mExpectedValue;
+            }
+            
+            std::string actualValue () const
+            {
+                return mActualValue;
+            }
+            
+        protected:
+            std::string mExpectedValue;
+            std::string mActualValue;
+            
+        private:
+            void initialize ()
+            {
+                mMessage = "    Throws verification failed.\n"
+                           "        Expected: " + expectedValue() + "\n"
+                           "          Actual: " + actualValue() + "\n";
+            }
+        };
+        
+        class NoThrowVerificationException : public VerificationException
+        {
+        public:
+            // The actual value describes the exception that was thrown, as given by
+            // ThrowsVerificationException::currentExceptionDescription.
+            NoThrowVerificationException (const std::string & actualValue)
+            : mActualValue(actualValue)
+            {
+                initialize();
+            }
+            
+            std::string actualValue () const
+            {
+                return mActualValue;
+            }
+            
+        protected:
+            std::string mActualValue;
+            
+        private:
+            void initialize ()
+            {
+                mMessage = "    No throw verification failed.\n"
+                           "        Actual: " + mActualValue + "\n";
+            }
+        };
+        
         class EqualVerificationException : public VerificationException
         {
         public:
@@ -176,212 +301,809 @@ namespace MuddledManaged
             }
         };
         
-        class ScenarioBase
+        // Defined only when coroutines are available. Category and ScenarioManager refer to it without depending
+        // on its definition, so their layout and virtual functions are the same whichever standard each file is
+        // compiled with. Everything that does depend on coroutines is defined once in the runtime library.
+        class Executor;
+        
+        // Receives the result of each scenario as soon as it finishes. Results can arrive from any thread.
+        class ResultRecorder
         {
         public:
-            virtual ~ScenarioBase ()
+            virtual ~ResultRecorder ()
             { }
             
-            virtual std::string categoryFullName () const
+            virtual void recordResult (bool passed) = 0;
+        };
+        
+        // Counts passed and failed results. Each thread adds to its own slot so that workers finishing scenarios
+        // at the same time do not contend for one counter, and reads merge the slots. Counts can be read from any
+        // thread while results are still being added.
+        class ResultCounter
+        {
+        public:
+            ResultCounter ()
             {
-                return mCategoryFullName;
+                clear();
             }
             
-            virtual std::string description () const
+            // Adds to the slot of the calling thread. The amounts can be negative to take earlier results back out.
+            void add (int passCount, int failCount)
             {
-                return mDescription;
+                Slot & slot = mSlots[slotIndex()];
+                if (passCount != 0)
+                {
+                    slot.passCount.fetch_add(passCount, std::memory_order_relaxed);
+                }
+                if (failCount != 0)
+                {
+                    slot.failCount.fetch_add(failCount, std::memory_order_relaxed);
+                }
             }
             
-            virtual bool exceptionExpected () const
+            // Only call this when no results are being added.
+            void clear ()
             {
-                return mExceptionExpected;
+                for (auto & slot : mSlots)
+                {
+                    slot.passCount.store(0, std::memory_order_relaxed);
+                    slot.failCount.store(0, std::memory_order_relaxed);
+                }
             }
             
-            virtual bool passed () const
+            int passCount () const
             {
-                return mRunPassed;
+                int count = 0;
+                for (auto & slot : mSlots)
+                {
+                    count += slot.passCount.load(std::memory_order_relaxed);
+                }
+                return count;
             }
             
-            virtual void run ()
+            int failCount () const
             {
-                // Scenarios will pass unless one of the verify methods fail.
-                mRunPassed = true;
-                
-                runSteps();
+                int count = 0;
+                for (auto & slot : mSlots)
+                {
+                    count += slot.failCount.load(std::memory_order_relaxed);
+                }
+                return count;
             }
             
-            virtual void runSteps () = 0;
+        private:
+            // Threads beyond this many share slots, which stays correct because the slots are atomic.
+            static const unsigned int SlotCount = 16;
+            
+            // Slots are padded to twice a cache line so the counters of neighbouring slots never share a line,
+            // whatever the alignment of the array.
+            struct Slot
+            {
+                std::atomic<int> passCount;
+                std::atomic<int> failCount;
+                char padding[128 - 2 * sizeof(std::atomic<int>)];
+            };
             
-            virtual std::shared_ptr<ScenarioBase> clone () const = 0;
-
-            virtual void verifyTrue (bool actualValue)
+            static unsigned int slotIndex ()
             {
-                if (!actualValue)
-                {
-                    mRunPassed = false;
-                    throw BoolVerificationException(true);
-                }
+                static std::atomic<unsigned int> nextIndex(0);
+                static thread_local unsigned int index = nextIndex.fetch_add(1, std::memory_order_relaxed) % SlotCount;
+                return index;
             }
             
-            virtual void verifyFalse (bool actualValue)
+            ResultCounter (const ResultCounter & src) = delete;
+            ResultCounter & operator = (const ResultCounter & rhs) = delete;
+            
+            Slot mSlots[SlotCount];
+        };
+        
+        // Tracks how far a run has progressed. Snapshots can be taken from any thread while the run is still going.
+        class RunProgress : public ResultRecorder
+        {
+        public:
+            struct Snapshot
             {
-                if (actualValue)
+                int scenarioCount;
+                int passCount;
+                int failCount;
+                
+                int finishedCount () const
                 {
-                    mRunPassed = false;
-                    throw BoolVerificationException(false);
+                    return passCount + failCount;
                 }
+            };
+            
+            RunProgress ()
+            : mScenarioCount(0)
+            { }
+            
+            // Only call this between runs when no scenarios are recording results.
+            virtual void reset (int scenarioCount)
+            {
+                mCounts.clear();
+                mScenarioCount.store(scenarioCount, std::memory_order_release);
             }
             
-            virtual void verifyEqual (bool expectedValue, bool actualValue)
+            virtual void recordResult (bool passed)
             {
-                if (actualValue != expectedValue)
-                {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
-                }
+                mCounts.add(passed ? 1 : 0, passed ? 0 : 1);
             }
-
-            virtual void verifyEqual (int expectedValue, int actualValue)
+            
+            virtual Snapshot snapshot () const
+            {
+                Snapshot result;
+                result.scenarioCount = mScenarioCount.load(std::memory_order_acquire);
+                result.passCount = mCounts.passCount();
+                result.failCount = mCounts.failCount();
+                return result;
+            }
+            
+            virtual std::string statusLine () const
+            {
+                Snapshot current = snapshot();
+                std::ostringstream line;
+                line << "Finished " << current.finishedCount() << " of " << current.scenarioCount <<
+                    " scenarios. Passed: " << current.passCount << " Failed: " << current.failCount;
+                return line.str();
+            }
+            
+        private:
+            RunProgress (const RunProgress & src) = delete;
+            RunProgress & operator = (const RunProgress & rhs) = delete;
+            
+            std::atomic<int> mScenarioCount;
+            ResultCounter mCounts;
+        };
+        
+#ifdef DESIGNER_COROUTINES_ENABLED
+        class IncompleteScenarioException : public VerificationException
+        {
+        public:
+            IncompleteScenarioException ()
+            {
+                initialize();
+            }
+            
+        private:
+            void initialize ()
+            {
+                mMessage = "    Asynchronous scenario did not complete.\n"
+                           "        It was still waiting when no remaining work could resume it.\n";
+            }
+        };
+        
+        class Executor
+        {
+        public:
+            virtual ~Executor ()
+            { }
+            
+            virtual void post (std::coroutine_handle<> handle) = 0;
+            
+            virtual void postAfter (std::chrono::steady_clock::duration delay, std::coroutine_handle<> handle) = 0;
+            
+            virtual void run () = 0;
+        };
+        
+        class EventLoop : public Executor
+        {
+        public:
+            explicit EventLoop (unsigned int threadCount = 1)
+            : mThreadCount(threadCount == 0 ? 1 : threadCount), mBusyCount(0), mTimerSequence(0)
+            { }
+            
+            virtual void post (std::coroutine_handle<> handle)
             {
-                if (actualValue != expectedValue)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mReady.push_back(handle);
                 }
+                mCondition.notify_one();
             }
-
-            virtual void verifyEqual (unsigned int expectedValue, unsigned int actualValue)
+            
+            virtual void postAfter (std::chrono::steady_clock::duration delay, std::coroutine_handle<> handle)
             {
-                if (actualValue != expectedValue)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mTimers.push(Timer{std::chrono::steady_clock::now() + delay, mTimerSequence++, handle});
                 }
+                // A sooner deadline than the one a thread is already waiting for needs to wake that thread.
+                mCondition.notify_all();
             }
-
-            virtual void verifyEqual (long expectedValue, long actualValue)
+            
+            // Resumes handles on the calling thread and on threadCount - 1 worker threads. Returns once nothing is
+            // ready, no timers are pending, and no thread is busy resuming a handle that could post more work.
+            virtual void run ()
             {
-                if (actualValue != expectedValue)
+                std::vector<std::thread> workers;
+                for (unsigned int i = 1; i < mThreadCount; ++i)
+                {
+                    workers.emplace_back([this] () { work(); });
+                }
+                work();
+                for (auto & worker : workers)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    worker.join();
                 }
             }
-
-            virtual void verifyEqual (unsigned long expectedValue, unsigned long actualValue)
+            
+        private:
+            struct Timer
             {
-                if (actualValue != expectedValue)
+                std::chrono::steady_clock::time_point deadline;
+                unsigned long sequence;
+                std::coroutine_handle<> handle;
+                
+                bool operator > (const Timer & rhs) const
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    if (deadline != rhs.deadline)
+                    {
+                        return deadline > rhs.deadline;
+                    }
+                    return sequence > rhs.sequence;
                 }
-            }
-
-            virtual void verifyEqual (float expectedValue, float actualValue)
+            };
+            
+            void work ()
             {
-                if (actualValue != expectedValue)
+                std::unique_lock<std::mutex> lock(mMutex);
+                while (true)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    auto now = std::chrono::steady_clock::now();
+                    while (!mTimers.empty() && mTimers.top().deadline <= now)
+                    {
+                        mReady.push_back(mTimers.top().handle);
+                        mTimers.pop();
+                    }
+                    
+                    if (!mReady.empty())
+                    {
+                        auto handle = mReady.front();
+                        mReady.pop_front();
+                        ++mBusyCount;
+                        lock.unlock();
+                        handle.resume();
+                        lock.lock();
+                        --mBusyCount;
+                        if (mBusyCount == 0 && mReady.empty() && mTimers.empty())
+                        {
+                            mCondition.notify_all();
+                        }
+                        continue;
+                    }
+                    
+                    if (mBusyCount == 0 && mTimers.empty())
+                    {
+                        return;
+                    }
+                    
+                    if (mTimers.empty())
+                    {
+                        mCondition.wait(lock);
+                    }
+                    else
+                    {
+                        mCondition.wait_until(lock, mTimers.top().deadline);
+                    }
                 }
             }
-
-            virtual void verifyEqual (double expectedValue, double actualValue)
+            
+            unsigned int mThreadCount;
+            unsigned int mBusyCount;
+            unsigned long mTimerSequence;
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::deque<std::coroutine_handle<>> mReady;
+            std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> mTimers;
+        };
+        
+        class ScenarioTask
+        {
+        public:
+            class promise_type
             {
-                if (actualValue != expectedValue)
+            public:
+                struct FinalAwaiter
+                {
+                    bool await_ready () const noexcept
+                    {
+                        return false;
+                    }
+                    
+                    std::coroutine_handle<> await_suspend (std::coroutine_handle<promise_type> handle) noexcept
+                    {
+                        // Continue whichever task awaited this one. A top level task stays suspended so its
+                        // scenario can check that it finished.
+                        if (handle.promise().mContinuation)
+                        {
+                            return handle.promise().mContinuation;
+                        }
+                        return std::noop_coroutine();
+                    }
+                    
+                    void await_resume () const noexcept
+                    { }
+                };
+                
+                ScenarioTask get_return_object ()
+                {
+                    return ScenarioTask(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+                
+                std::suspend_always initial_suspend () const noexcept
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    return {};
                 }
+                
+                FinalAwaiter final_suspend () const noexcept
+                {
+                    return {};
+                }
+                
+                void return_void () const
+                { }
+                
+                void unhandled_exception ()
+                {
+                    mException = std::current_exception();
+                }
+                
+                std::coroutine_handle<> mContinuation;
+                std::exception_ptr mException;
+            };
+            
+            ScenarioTask ()
+            { }
+            
+            ScenarioTask (ScenarioTask && src) noexcept
+            : mHandle(src.mHandle)
+            {
+                src.mHandle = nullptr;
             }
-
-            virtual void verifyEqual (const std::string & expectedValue, const std::string & actualValue)
+            
+            ~ScenarioTask ()
             {
-                if (actualValue != expectedValue)
+                if (mHandle)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    mHandle.destroy();
                 }
             }
-
-            virtual void verifyEqual (const std::wstring & expectedValue, const std::wstring & actualValue)
+            
+            ScenarioTask & operator = (ScenarioTask && rhs) noexcept
             {
-                if (actualValue != expectedValue)
+                if (this != &rhs)
                 {
-                    mRunPassed = false;
-                    throw EqualVerificationException(expectedValue, actualValue);
+                    if (mHandle)
+                    {
+                        mHandle.destroy();
+                    }
+                    mHandle = rhs.mHandle;
+                    rhs.mHandle = nullptr;
                 }
+                return *this;
+            }
+            
+            std::coroutine_handle<> handle () const
+            {
+                return mHandle;
+            }
+            
+            bool done () const
+            {
+                return !mHandle || mHandle.done();
             }
             
-            template <typename T>
-            void verifySame (T * expectedValue, T * actualValue)
+            void rethrow () const
             {
-                if (actualValue != expectedValue)
+                if (mHandle && mHandle.promise().mException)
                 {
-                    mRunPassed = false;
-                    throw SameVerificationException();
+                    std::rethrow_exception(mHandle.promise().mException);
                 }
             }
             
-        protected:
-            ScenarioBase (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
-            : mCategoryFullName(categoryFullName), mDescription(scenarioDescription), mExceptionExpected(exceptionExpected)
-            { }
+            // Awaiting a task runs it inline on the awaiting thread and resumes the awaiter when it finishes.
+            bool await_ready () const noexcept
+            {
+                return done();
+            }
             
-            ScenarioBase (const ScenarioBase & src)
-            : mCategoryFullName(src.mCategoryFullName), mDescription(src.mDescription), mExceptionExpected(src.mExceptionExpected)
-            { }
+            std::coroutine_handle<> await_suspend (std::coroutine_handle<> awaiting) noexcept
+            {
+                mHandle.promise().mContinuation = awaiting;
+                return mHandle;
+            }
+            
+            void await_resume () const
+            {
+                rethrow();
+            }
             
         private:
-            ScenarioBase & operator = (const ScenarioBase & rhs) = delete;
+            explicit ScenarioTask (std::coroutine_handle<promise_type> handle)
+            : mHandle(handle)
+            { }
+            
+            ScenarioTask (const ScenarioTask & src) = delete;
+            ScenarioTask & operator = (const ScenarioTask & rhs) = delete;
             
-            std::string mCategoryFullName;
-            std::string mDescription;
-            bool mExceptionExpected;
-            bool mRunPassed;
+            std::coroutine_handle<promise_type> mHandle;
         };
         
-        template <typename ExceptionT = std::exception>
-        class Scenario : public ScenarioBase
+        // One suspended wait on an AsyncEvent. Whichever comes first, the event being set or the waiting scenario
+        // giving up, claims the waiter. A scenario whose coroutine is destroyed while still waiting claims it
+        // first, so a later set neither resumes the freed frame nor posts to an executor that has gone away.
+        class AsyncEventWaiter
         {
         public:
-            Scenario (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
-            : ScenarioBase(categoryFullName, scenarioDescription, exceptionExpected)
+            AsyncEventWaiter (Executor * executor, std::coroutine_handle<> handle)
+            : mExecutor(executor), mHandle(handle), mClaimed(false)
             { }
             
-            virtual ~Scenario ()
-            { }
+            bool claim ()
+            {
+                return !mClaimed.exchange(true);
+            }
             
-        protected:
-            Scenario (const Scenario & src)
-            : ScenarioBase(src)
-            { }
+            void resume ()
+            {
+                if (claim())
+                {
+                    mExecutor->post(mHandle);
+                }
+            }
             
         private:
-            Scenario & operator = (const Scenario & rhs) = delete;
+            AsyncEventWaiter (const AsyncEventWaiter & src) = delete;
+            AsyncEventWaiter & operator = (const AsyncEventWaiter & rhs) = delete;
+            
+            Executor * mExecutor;
+            std::coroutine_handle<> mHandle;
+            std::atomic<bool> mClaimed;
         };
         
-        class Category
+        // A local stand-in for a socket or other completion source. Awaiting scenarios are resumed through their
+        // executor once the event is set, and later waits complete immediately.
+        class AsyncEvent
         {
-            friend class ScenarioManager;
-            
         public:
-            Category (const std::string & name, const std::string & fullName)
-            : mName(name), mFullName(fullName), mPassCount(0), mFailCount(0)
+            AsyncEvent ()
+            : mSet(false)
+            { }
+            
+            bool isSet () const
             {
+                std::lock_guard<std::mutex> lock(mMutex);
+                return mSet;
             }
             
-            Category (const Category & src)
-            : mName(src.mName), mChildCategories(src.mChildCategories), mChildScenarios(src.mChildScenarios),
-              mPassCount(src.mPassCount), mFailCount(src.mFailCount)
-            { }
-            
-            virtual ~Category ()
-            { }
+            void set ()
+            {
+                std::vector<std::shared_ptr<AsyncEventWaiter>> waiters;
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mSet = true;
+                    waiters.swap(mWaiters);
+                }
+                for (auto & waiter : waiters)
+                {
+                    waiter->resume();
+                }
+            }
             
-            virtual std::string name () const
+            void reset ()
             {
-                return mName;
+                std::lock_guard<std::mutex> lock(mMutex);
+                mSet = false;
+            }
+            
+            bool addWaiter (const std::shared_ptr<AsyncEventWaiter> & waiter)
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (mSet)
+                {
+                    return false;
+                }
+                mWaiters.push_back(waiter);
+                return true;
+            }
+            
+        private:
+            AsyncEvent (const AsyncEvent & src) = delete;
+            AsyncEvent & operator = (const AsyncEvent & rhs) = delete;
+            
+            mutable std::mutex mMutex;
+            bool mSet;
+            std::vector<std::shared_ptr<AsyncEventWaiter>> mWaiters;
+        };
+        
+        // Defined only by a runtime built with coroutine support. Asynchronous scenarios call it so that linking
+        // them against a runtime that cannot run them concurrently fails instead of misbehaving.
+        void requireCoroutineRuntime ();
+        
+        // Everything about an asynchronous scenario except the type of exception it may expect. Its run only
+        // launches the steps, so whether the expected exception was thrown is checked once the steps complete
+        // instead of in Scenario::run.
+        class AsyncScenarioBase : public ScenarioBase
+        {
+        public:
+            virtual ~AsyncScenarioBase ()
+            { }
+            
+            virtual bool asynchronous () const
+            {
+                return true;
+            }
+            
+            virtual ScenarioTask runStepsAsync () = 0;
+            
+            // Running an asynchronous scenario by itself drives it to completion on a private event loop.
+            virtual void runSteps ()
+            {
+                if (mExecutor != nullptr)
+                {
+                    launch();
+                    return;
+                }
+                
+                EventLoop eventLoop;
+                mExecutor = &eventLoop;
+                launch();
+                eventLoop.run();
+                finish();
+            }
+            
+            // Starts the scenario on a shared executor so it can wait alongside other scenarios. The recorder, if
+            // any, is given the result on whichever thread completes the scenario. The caller runs the executor
+            // and then calls finish to report the result.
+            virtual void start (Executor & executor, ResultRecorder * recorder = nullptr)
+            {
+                mExecutor = &executor;
+                mRecorder = recorder;
+                run();
+            }
+            
+            virtual bool started () const
+            {
+                return mExecutor != nullptr;
+            }
+            
+            // True once the scenario has completed and given its result to the recorder passed to start.
+            virtual bool recorded () const
+            {
+                return mRecorded;
+            }
+            
+            virtual void finish ()
+            {
+                mExecutor = nullptr;
+                mRecorder = nullptr;
+                // An event may still hold the waiter of a scenario that never completed. Claim it before the
+                // coroutine frame is destroyed below.
+                if (mEventWaiter)
+                {
+                    mEventWaiter->claim();
+                    mEventWaiter.reset();
+                }
+                ScenarioTask task = std::move(mTask);
+                if (!task.done())
+                {
+                    throw IncompleteScenarioException();
+                }
+                if (mException)
+                {
+                    std::exception_ptr exception = mException;
+                    mException = nullptr;
+                    std::rethrow_exception(exception);
+                }
+            }
+            
+            Executor & executor () const
+            {
+                return *mExecutor;
+            }
+            
+            struct SleepAwaiter
+            {
+                Executor * executor;
+                std::chrono::steady_clock::duration delay;
+                
+                bool await_ready () const noexcept
+                {
+                    return false;
+                }
+                
+                void await_suspend (std::coroutine_handle<> handle) const
+                {
+                    executor->postAfter(delay, handle);
+                }
+                
+                void await_resume () const noexcept
+                { }
+            };
+            
+            struct YieldAwaiter
+            {
+                Executor * executor;
+                
+                bool await_ready () const noexcept
+                {
+                    return false;
+                }
+                
+                void await_suspend (std::coroutine_handle<> handle) const
+                {
+                    executor->post(handle);
+                }
+                
+                void await_resume () const noexcept
+                { }
+            };
+            
+            struct EventAwaiter
+            {
+                AsyncScenarioBase * scenario;
+                AsyncEvent * event;
+                
+                bool await_ready () const
+                {
+                    return event->isSet();
+                }
+                
+                bool await_suspend (std::coroutine_handle<> handle) const
+                {
+                    // The scenario keeps its current waiter so finish can cancel it.
+                    scenario->mEventWaiter = std::make_shared<AsyncEventWaiter>(scenario->mExecutor, handle);
+                    return event->addWaiter(scenario->mEventWaiter);
+                }
+                
+                void await_resume () const noexcept
+                { }
+            };
+            
+            SleepAwaiter sleepFor (std::chrono::steady_clock::duration delay) const
+            {
+                return SleepAwaiter{mExecutor, delay};
+            }
+            
+            YieldAwaiter yield () const
+            {
+                return YieldAwaiter{mExecutor};
+            }
+            
+            EventAwaiter waitFor (AsyncEvent & event)
+            {
+                return EventAwaiter{this, &event};
+            }
+            
+        protected:
+            AsyncScenarioBase (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
+            : ScenarioBase(categoryFullName, scenarioDescription, exceptionExpected), mExecutor(nullptr),
+              mRecorder(nullptr), mRecorded(false)
+            {
+                requireCoroutineRuntime();
+            }
+            
+            AsyncScenarioBase (const AsyncScenarioBase & src)
+            : ScenarioBase(src), mExecutor(nullptr), mRecorder(nullptr), mRecorded(false)
+            { }
+            
+            // Called once the steps of a scenario that expects an exception complete, with the exception they
+            // threw or null. Returns normally only if it is the expected exception.
+            virtual void verifyExpectedException (std::exception_ptr exception) = 0;
+            
+        private:
+            void launch ()
+            {
+                mRecorded = false;
+                mException = nullptr;
+                mTask = drive();
+                mExecutor->post(mTask.handle());
+            }
+            
+            // Runs the scenario steps and records the result the moment they complete.
+            ScenarioTask drive ()
+            {
+                ScenarioTask steps = runStepsAsync();
+                try
+                {
+                    co_await steps;
+                }
+                catch (...)
+                {
+                    mException = std::current_exception();
+                }
+                
+                if (exceptionExpected())
+                {
+                    try
+                    {
+                        verifyExpectedException(mException);
+                        mException = nullptr;
+                    }
+                    catch (...)
+                    {
+                        mException = std::current_exception();
+                    }
+                }
+                
+                if (mRecorder != nullptr)
+                {
+                    mRecorder->recordResult(!mException && passed());
+                    mRecorded = true;
+                }
+            }
+            
+            AsyncScenarioBase & operator = (const AsyncScenarioBase & rhs) = delete;
+            
+            Executor * mExecutor;
+            ResultRecorder * mRecorder;
+            bool mRecorded;
+            std::exception_ptr mException;
+            std::shared_ptr<AsyncEventWaiter> mEventWaiter;
+            ScenarioTask mTask;
+        };
+        
+        template <typename ExceptionT = std::exception>
+        class AsyncScenario : public AsyncScenarioBase
+        {
+        public:
+            AsyncScenario (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
+            : AsyncScenarioBase(categoryFullName, scenarioDescription, exceptionExpected)
+            { }
+            
+            virtual ~AsyncScenario ()
+            { }
+            
+        protected:
+            AsyncScenario (const AsyncScenario & src)
+            : AsyncScenarioBase(src)
+            { }
+            
+            // A scenario that expects an exception passes only if its steps throw ExceptionT. Any other exception
+            // is reported as a throws verification failure.
+            virtual void verifyExpectedException (std::exception_ptr exception)
+            {
+                try
+                {
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                }
+                catch (const ExceptionT &)
+                {
+                    rethrowIfFailed();
+                    return;
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failThrowsOther(typeid(ExceptionT));
+                }
+                failThrowsNothing(typeid(ExceptionT));
+            }
+            
+        private:
+            AsyncScenario & operator = (const AsyncScenario & rhs) = delete;
+        };
+#endif // DESIGNER_COROUTINES_ENABLED
+        
+        class Category : public ResultRecorder
+        {
+            friend class ScenarioManager;
+            
+        public:
+            Category (const std::string & name, const std::string & fullName)
+            : mName(name), mFullName(fullName), mParent(nullptr), mProgress(nullptr)
+            {
+            }
+            
+            virtual ~Category ()
+            { }
+            
+            virtual std::string name () const
+            {
+                return mName;
             }
 
             virtual std::string fullName () const
@@ -389,14 +1111,26 @@ namespace MuddledManaged
                 return mFullName;
             }
 
+            // The counts include every scenario in child categories and are updated as each scenario finishes,
+            // so they can be read from any thread while a run is still going.
             virtual int passCount () const
             {
-                return mPassCount;
+                return mCounts.passCount();
             }
 
             virtual int failCount () const
             {
-                return mFailCount;
+                return mCounts.failCount();
+            }
+
+            virtual int scenarioCount () const
+            {
+                int count = static_cast<int>(mChildScenarios.size());
+                for (auto & category : mChildCategories)
+                {
+                    count += category->scenarioCount();
+                }
+                return count;
             }
 
             std::vector<std::shared_ptr<Category>> categories ()
@@ -409,6 +1143,25 @@ namespace MuddledManaged
                 return mChildScenarios;
             }
             
+            // Returns the child category with this name, creating it if needed.
+            virtual std::shared_ptr<Category> registerCategory (const std::string & name)
+            {
+                for (auto & category : mChildCategories)
+                {
+                    if (category->mName == name)
+                    {
+                        return category;
+                    }
+                }
+                
+                std::shared_ptr<Category> newCategory(new Category(name, mFullName + "/" + name));
+                newCategory->mParent = this;
+                newCategory->mProgress = mProgress;
+                mChildCategories.push_back(newCategory);
+                
+                return newCategory;
+            }
+            
             virtual std::shared_ptr<ScenarioBase> registerScenario (const ScenarioBase * scenario)
             {
                 std::shared_ptr<ScenarioBase> sharedScenario(scenario->clone());
@@ -418,77 +1171,62 @@ namespace MuddledManaged
                 return sharedScenario;
             }
             
-            virtual void run (std::ostream & stream)
+            // Adds one result to this category and to every parent category above it. Each category keeps a
+            // separate count for each worker thread, so workers finishing scenarios under the same top-level
+            // category do not contend for its counters.
+            virtual void recordResult (bool passed)
             {
-                mPassCount = 0;
-                mFailCount = 0;
-
-                int childCategoryPassCount = 0;
-                int childCategoryFailCount = 0;
-                for (auto & category : mChildCategories)
+                for (Category * category = this; category != nullptr; category = category->mParent)
                 {
-                    category->run(stream);
-                    childCategoryPassCount += category->passCount();
-                    childCategoryFailCount += category->failCount();
+                    category->mCounts.add(passed ? 1 : 0, passed ? 0 : 1);
                 }
                 
-                if (!mChildScenarios.empty())
+                if (mProgress != nullptr)
                 {
-                    stream << "----- Running scenarios in: " << fullName() << " -----" << std::endl;
+                    mProgress->recordResult(passed);
                 }
-                int localPassCount = 0;
-                int localFailCount = 0;
-                for (auto & scenario : mChildScenarios)
+            }
+            
+            // Starts every asynchronous scenario in this category and its children that is not already running.
+            virtual bool startAsyncScenarios (Executor & executor);
+            
+            virtual void run (std::ostream & stream);
+            
+        private:
+            // A copy would share child categories whose results still go to this category and its parents.
+            Category (const Category & src) = delete;
+            Category & operator = (const Category & rhs) = delete;
+            
+            // Removes the results from the previous run of this category, including those already added to its
+            // parent categories.
+            void resetCounts ()
+            {
+                int passCount = mCounts.passCount();
+                int failCount = mCounts.failCount();
+                for (Category * parent = mParent; parent != nullptr; parent = parent->mParent)
                 {
-                    try
-                    {
-                        scenario->run();
-                        if (scenario->passed())
-                        {
-                            localPassCount++;
-                            stream << "Scenario passed: " <<
-                                scenario->description() << std::endl;
-                        }
-                        else
-                        {
-                            localFailCount++;
-                            stream << "Scenario failed: " <<
-                                scenario->description() << std::endl;
-                        }
-                    }
-                    catch (VerificationException ex)
-                    {
-                        localFailCount++;
-                        stream << "Scenario failed: " <<
-                            scenario->description() << std::endl <<
-                            ex.what();
-                        continue;
-                    }
-                    catch (...)
-                    {
-                        localFailCount++;
-                        stream << "Scenario failed unexpectedly: " <<
-                            scenario->description() << std::endl;
-                        continue;
-                    }
+                    parent->mCounts.add(-passCount, -failCount);
                 }
-                if (!mChildScenarios.empty())
+                clearCounts();
+            }
+            
+            void clearCounts ()
+            {
+                mCounts.clear();
+                for (auto & category : mChildCategories)
                 {
-                    stream << "----- Passed: " << localPassCount << " Failed: " << localFailCount << " -----" << std::endl;
-                    stream << std::endl;
+                    category->clearCounts();
                 }
-
-                mPassCount = childCategoryPassCount + localPassCount;
-                mFailCount = childCategoryFailCount + localFailCount;
             }
             
-        private:
-            Category & operator = (const Category & rhs) = delete;
+            void runCategory (std::ostream & stream);
             
             std::string mName;
             std::string mFullName;
-            int mPassCount;
-            int mFailCount;
+            ResultCounter mCounts;
+            // The parent is not owned. Parents own their children through shared_ptr.
+            Category * mParent;
+            RunProgress * mProgress;
             // We can use shared_ptr for child stories because there are no cyclic links.
             std::vector<std::shared_ptr<Category>> mChildCategories;
             std::vector<std::shared_ptr<ScenarioBase>> mChildScenarios;
@@ -547,16 +1285,18 @@ namespace MuddledManaged
                     auto categoryIter = mAllCategories.find(currentFullName);
                     if (categoryIter == mAllCategories.end())
                     {
-                        std::shared_ptr<Category> newCategory(new Category(currentName, categoryFullName));
-                        categoryIter = mAllCategories.insert({currentFullName, newCategory}).first;
+                        std::shared_ptr<Category> newCategory;
                         if (previousCategory)
                         {
-                            previousCategory->mChildCategories.push_back(newCategory);
+                            newCategory = previousCategory->registerCategory(currentName);
                         }
                         else
                         {
+                            newCategory.reset(new Category(currentName, currentFullName));
+                            newCategory->mProgress = &mProgress;
                             mTopLevelCategories.push_back(newCategory);
                         }
+                        categoryIter = mAllCategories.insert({currentFullName, newCategory}).first;
                     }
                     
                     previousCategory = categoryIter->second;
@@ -567,24 +1307,31 @@ namespace MuddledManaged
                 return previousCategory;
             }
             
-            virtual void run (std::ostream & stream)
+            // The number of threads that run asynchronous scenarios. It has no effect when the runtime is built
+            // without coroutine support.
+            unsigned int asyncThreadCount () const
             {
-                int passCount = 0;
-                int failCount = 0;
-                for (auto & category : mTopLevelCategories)
-                {
-                    category->run(stream);
-                    passCount += category->passCount();
-                    failCount += category->failCount();
-                }
-                stream << "----- Summary -----" << std::endl;
-                stream << "Total number of tests run: " << passCount + failCount << std::endl;
-                stream << "Tests passed: " << passCount << std::endl;
-                stream << "Tests failed: " << failCount << std::endl;
+                return mAsyncThreadCount;
+            }
+            
+            void setAsyncThreadCount (unsigned int threadCount)
+            {
+                mAsyncThreadCount = threadCount == 0 ? 1 : threadCount;
             }
             
+            // The progress of the current or most recent run, whether of every category or of one category run by
+            // itself. It is safe to read from another thread, for example to show a status line while a long run is
+            // still going.
+            const RunProgress & progress () const
+            {
+                return mProgress;
+            }
+            
+            virtual void run (std::ostream & stream);
+            
         private:
             ScenarioManager ()
+            : mAsyncThreadCount(1)
             {
                 mAllCategories.clear();
                 mTopLevelCategories.clear();
@@ -592,43 +1339,45 @@ namespace MuddledManaged
             
             std::map<std::string, std::shared_ptr<Category>> mAllCategories;
             std::vector<std::shared_ptr<Category>> mTopLevelCategories;
+            RunProgress mProgress;
+            unsigned int mAsyncThreadCount;
         };
         
     } // namespace Designer
     
 } // namespace MuddledManaged
 
-#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_FINAL( name, line ) ClassDesigner ## name ## line
-#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_RELAY( name, line ) INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_FINAL( name, line )
-#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( name ) INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_RELAY( name, __LINE__ )
-
-#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_FINAL( name, line ) InstanceDesigner ## name ## line
-#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_RELAY( name, line ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_FINAL( name, line )
-#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME( name ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_RELAY( name, __LINE__ )
+#ifdef DESIGNER_COROUTINES_ENABLED
 
-#define DESIGNER_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription ) class INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) \
-: public Designer::Scenario<> \
+// The body of an asynchronous scenario is a coroutine and must contain at least one co_await or co_return.
+#define INTERNAL_DESIGNER_ASYNC_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType, preprocExceptionExpected ) class INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) \
+: public Designer::AsyncScenario<preprocExceptionType> \
 { \
 public: \
     INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected) \
-    : Designer::Scenario<>(categoryFullName, scenarioDescription, exceptionExpected) \
+    : Designer::AsyncScenario<preprocExceptionType>(categoryFullName, scenarioDescription, exceptionExpected) \
     { \
-        auto scenarioManager = Designer::ScenarioManager::instance(); \
-        auto category = scenarioManager->registerCategory(categoryFullName); \
-        category->registerScenario(this); \
+        Designer::registerScenario(this); \
     } \
     virtual std::shared_ptr<Designer::ScenarioBase> clone () const \
     { \
         return std::shared_ptr<Designer::ScenarioBase>(new INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName )(*this)); \
     } \
-    virtual void runSteps (); \
+    virtual Designer::ScenarioTask runStepsAsync (); \
 protected: \
     INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) (const INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) & src) \
-    : Designer::Scenario<>(src) \
+    : Designer::AsyncScenario<preprocExceptionType>(src) \
     { } \
 }; \
-INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME( preprocGroupName )(preprocCategoryName, preprocScenarioDescription, false); \
-void INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName )::runSteps ()
+INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME( preprocGroupName )(preprocCategoryName, preprocScenarioDescription, preprocExceptionExpected); \
+Designer::ScenarioTask INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName )::runStepsAsync ()
+
+#define DESIGNER_ASYNC_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription ) INTERNAL_DESIGNER_ASYNC_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, std::exception, false )
+
+// The asynchronous scenario passes only if its steps throw preprocExceptionType or a type derived from it.
+#define DESIGNER_ASYNC_EXCEPTION_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType ) INTERNAL_DESIGNER_ASYNC_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType, true )
+
+#endif // DESIGNER_COROUTINES_ENABLED
 
 #ifdef DESIGNER_GENERATE_MAIN
 
@@ -671,6 +1420,379 @@ namespace MuddledManaged
             return strm;
         }
         
+#ifdef DESIGNER_COROUTINES_ENABLED
+        void requireCoroutineRuntime ()
+        { }
+        
+#endif // DESIGNER_COROUTINES_ENABLED
+        bool Category::startAsyncScenarios (Executor & executor)
+        {
+#ifdef DESIGNER_COROUTINES_ENABLED
+            bool anyStarted = false;
+            for (auto & category : mChildCategories)
+            {
+                if (category->startAsyncScenarios(executor))
+                {
+                    anyStarted = true;
+                }
+            }
+            
+            for (auto & scenario : mChildScenarios)
+            {
+                if (scenario->asynchronous())
+                {
+                    auto asyncScenario = static_cast<AsyncScenarioBase *>(scenario.get());
+                    if (!asyncScenario->started())
+                    {
+                        asyncScenario->start(executor, this);
+                        anyStarted = true;
+                    }
+                }
+            }
+            
+            return anyStarted;
+#else
+            return false;
+#endif // DESIGNER_COROUTINES_ENABLED
+        }
+        
+        void Category::run (std::ostream & stream)
+        {
+            resetCounts();
+            if (mProgress != nullptr)
+            {
+                mProgress->reset(scenarioCount());
+            }
+            
+#ifdef DESIGNER_COROUTINES_ENABLED
+            // Like ScenarioManager::run, every asynchronous scenario in this category and its children waits
+            // together on one event loop, so scenarios in different child categories can resolve each other.
+            EventLoop eventLoop(ScenarioManager::instance()->asyncThreadCount());
+            if (startAsyncScenarios(eventLoop))
+            {
+                eventLoop.run();
+            }
+#endif // DESIGNER_COROUTINES_ENABLED
+            
+            runCategory(stream);
+        }
+        
+        void Category::runCategory (std::ostream & stream)
+        {
+            for (auto & category : mChildCategories)
+            {
+                category->runCategory(stream);
+            }
+            
+            if (!mChildScenarios.empty())
+            {
+                stream << "----- Running scenarios in: " << fullName() << " -----" << std::endl;
+            }
+            int localPassCount = 0;
+            int localFailCount = 0;
+            for (auto & scenario : mChildScenarios)
+            {
+                // Asynchronous scenarios were started and run to completion before reporting began, and record
+                // their result as soon as they complete.
+                bool alreadyRecorded = false;
+                try
+                {
+#ifdef DESIGNER_COROUTINES_ENABLED
+                    if (scenario->asynchronous() && static_cast<AsyncScenarioBase *>(scenario.get())->started())
+                    {
+                        auto asyncScenario = static_cast<AsyncScenarioBase *>(scenario.get());
+                        alreadyRecorded = asyncScenario->recorded();
+                        asyncScenario->finish();
+                    }
+                    else
+#endif // DESIGNER_COROUTINES_ENABLED
+                    {
+                        scenario->run();
+                    }
+                    if (scenario->passed())
+                    {
+                        localPassCount++;
+                        if (!alreadyRecorded)
+                        {
+                            recordResult(true);
+                        }
+                        stream << "Scenario passed: " <<
+                            scenario->description() << std::endl;
+                    }
+                    else
+                    {
+                        localFailCount++;
+                        if (!alreadyRecorded)
+                        {
+                            recordResult(false);
+                        }
+                        stream << "Scenario failed: " <<
+                            scenario->description() << std::endl;
+                    }
+                }
+                catch (VerificationException ex)
+                {
+                    localFailCount++;
+                    if (!alreadyRecorded)
+                    {
+                        recordResult(false);
+                    }
+                    stream << "Scenario failed: " <<
+                        scenario->description() << std::endl <<
+                        ex.what();
+                    continue;
+                }
+                catch (...)
+                {
+                    localFailCount++;
+                    if (!alreadyRecorded)
+                    {
+                        recordResult(false);
+                    }
+                    stream << "Scenario failed unexpectedly: " <<
+                        scenario->description() << std::endl;
+                    continue;
+                }
+            }
+            if (!mChildScenarios.empty())
+            {
+                stream << "----- Passed: " << localPassCount << " Failed: " << localFailCount << " -----" << std::endl;
+                stream << std::endl;
+            }
+        }
+        
+        void ScenarioManager::run (std::ostream & stream)
+        {
+            int scenarioCount = 0;
+            for (auto & category : mTopLevelCategories)
+            {
+                category->resetCounts();
+                scenarioCount += category->scenarioCount();
+            }
+            mProgress.reset(scenarioCount);
+            
+#ifdef DESIGNER_COROUTINES_ENABLED
+            // Every asynchronous scenario in every category waits together on one event loop before the
+            // categories report their results.
+            EventLoop eventLoop(mAsyncThreadCount);
+            bool asyncStarted = false;
+            for (auto & category : mTopLevelCategories)
+            {
+                if (category->startAsyncScenarios(eventLoop))
+                {
+                    asyncStarted = true;
+                }
+            }
+            if (asyncStarted)
+            {
+                eventLoop.run();
+            }
+#endif // DESIGNER_COROUTINES_ENABLED
+            
+            int passCount = 0;
+            int failCount = 0;
+            for (auto & category : mTopLevelCategories)
+            {
+                category->runCategory(stream);
+                passCount += category->passCount();
+                failCount += category->failCount();
+            }
+            stream << "----- Summary -----" << std::endl;
+            stream << "Total number of tests run: " << passCount + failCount << std::endl;
+            stream << "Tests passed: " << passCount << std::endl;
+            stream << "Tests failed: " << failCount << std::endl;
+        }
+        
+        template class Scenario<>;
+        
+        void registerScenario (const ScenarioBase * scenario)
+        {
+            auto scenarioManager = ScenarioManager::instance();
+            auto category = scenarioManager->registerCategory(scenario->categoryFullName());
+            category->registerScenario(scenario);
+        }
+        
+        ScenarioBase::~ScenarioBase ()
+        { }
+        
+        std::string ScenarioBase::categoryFullName () const
+        {
+            return mCategoryFullName;
+        }
+        
+        std::string ScenarioBase::description () const
+        {
+            return mDescription;
+        }
+        
+        bool ScenarioBase::exceptionExpected () const
+        {
+            return mExceptionExpected;
+        }
+        
+        bool ScenarioBase::passed () const
+        {
+            return mRunPassed;
+        }
+        
+        bool ScenarioBase::asynchronous () const
+        {
+            return false;
+        }
+        
+        void ScenarioBase::run ()
+        {
+            // Scenarios will pass unless one of the verify methods fail.
+            mRunPassed = true;
+            
+            runSteps();
+        }
+        
+        void ScenarioBase::verifyTrue (bool actualValue)
+        {
+            if (!actualValue)
+            {
+                mRunPassed = false;
+                throw BoolVerificationException(true);
+            }
+        }
+        
+        void ScenarioBase::verifyFalse (bool actualValue)
+        {
+            if (actualValue)
+            {
+                mRunPassed = false;
+                throw BoolVerificationException(false);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (bool expectedValue, bool actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (int expectedValue, int actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (unsigned int expectedValue, unsigned int actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (long expectedValue, long actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (unsigned long expectedValue, unsigned long actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (float expectedValue, float actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (double expectedValue, double actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (const std::string & expectedValue, const std::string & actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::verifyEqual (const std::wstring & expectedValue, const std::wstring & actualValue)
+        {
+            if (actualValue != expectedValue)
+            {
+                mRunPassed = false;
+                throw EqualVerificationException(expectedValue, actualValue);
+            }
+        }
+        
+        void ScenarioBase::failSame ()
+        {
+            mRunPassed = false;
+            throw SameVerificationException();
+        }
+        
+        bool ScenarioBase::currentExceptionIsExactly (const std::type_info & expectedType, const std::type_info & caughtType)
+        {
+#if defined(__GNUC__)
+            const std::type_info * thrownType = abi::__cxa_current_exception_type();
+            if (thrownType != nullptr)
+            {
+                return *thrownType == expectedType;
+            }
+#endif
+            return caughtType == expectedType;
+        }
+        
+        void ScenarioBase::failThrowsNothing (const std::type_info & expectedType)
+        {
+            mRunPassed = false;
+            throw ThrowsVerificationException("exception of type " + ThrowsVerificationException::typeName(expectedType),
+                                              "no exception");
+        }
+        
+        void ScenarioBase::failThrowsOther (const std::type_info & expectedType)
+        {
+            mRunPassed = false;
+            throw ThrowsVerificationException("exception of type " + ThrowsVerificationException::typeName(expectedType),
+                                              ThrowsVerificationException::currentExceptionDescription());
+        }
+        
+        void ScenarioBase::failThrowsMessage (const std::type_info & expectedType, const std::string & expectedMessage)
+        {
+            mRunPassed = false;
+            throw ThrowsVerificationException("exception of type " + ThrowsVerificationException::typeName(expectedType) +
+                                              " with message: " + expectedMessage,
+                                              ThrowsVerificationException::currentExceptionDescription());
+        }
+        
+        void ScenarioBase::failNoThrow ()
+        {
+            mRunPassed = false;
+            throw NoThrowVerificationException(ThrowsVerificationException::currentExceptionDescription());
+        }
+        
     } // namespace Designer
     
 } // namespace MuddledManaged
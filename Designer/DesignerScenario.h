@@ -0,0 +1,303 @@
+//
+//  DesignerScenario.h
+//  Designer
+//
+//  The lightweight header for files that only define scenarios. It declares ScenarioBase and the
+//  DESIGNER_SCENARIO macro without pulling in the categories, the scenario manager, or the verification
+//  exceptions. Everything declared here is defined once in the Designer runtime library, which is built
+//  from Designer.cpp, or in whichever file defines DESIGNER_GENERATE_GLOBALS before including Designer.h.
+//
+
+#ifndef Designer_DesignerScenario_h
+#define Designer_DesignerScenario_h
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+namespace MuddledManaged
+{
+    namespace Designer
+    {
+        class ScenarioBase
+        {
+        public:
+            virtual ~ScenarioBase ();
+
+            virtual std::string categoryFullName () const;
+
+            virtual std::string description () const;
+
+            virtual bool exceptionExpected () const;
+
+            virtual bool passed () const;
+
+            virtual bool asynchronous () const;
+
+            virtual void run ();
+
+            virtual void runSteps () = 0;
+
+            virtual std::shared_ptr<ScenarioBase> clone () const = 0;
+
+            virtual void verifyTrue (bool actualValue);
+
+            virtual void verifyFalse (bool actualValue);
+
+            virtual void verifyEqual (bool expectedValue, bool actualValue);
+
+            virtual void verifyEqual (int expectedValue, int actualValue);
+
+            virtual void verifyEqual (unsigned int expectedValue, unsigned int actualValue);
+
+            virtual void verifyEqual (long expectedValue, long actualValue);
+
+            virtual void verifyEqual (unsigned long expectedValue, unsigned long actualValue);
+
+            virtual void verifyEqual (float expectedValue, float actualValue);
+
+            virtual void verifyEqual (double expectedValue, double actualValue);
+
+            virtual void verifyEqual (const std::string & expectedValue, const std::string & actualValue);
+
+            virtual void verifyEqual (const std::wstring & expectedValue, const std::wstring & actualValue);
+
+            template <typename T>
+            void verifySame (T * expectedValue, T * actualValue)
+            {
+                if (actualValue != expectedValue)
+                {
+                    failSame();
+                }
+            }
+
+            // Passes when callable throws ExceptionT or a type derived from it. Matching is done by the catch
+            // clause so nothing is compared unless an exception is actually thrown.
+            template <typename ExceptionT, typename CallableT>
+            void verifyThrows (CallableT callable)
+            {
+                try
+                {
+                    callable();
+                }
+                catch (const ExceptionT &)
+                {
+                    rethrowIfFailed();
+                    return;
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failThrowsOther(typeid(ExceptionT));
+                }
+                failThrowsNothing(typeid(ExceptionT));
+            }
+
+            template <typename ExceptionT, typename CallableT>
+            void verifyThrows (CallableT callable, const std::string & expectedMessage)
+            {
+                try
+                {
+                    callable();
+                }
+                catch (const ExceptionT & ex)
+                {
+                    rethrowIfFailed();
+                    if (expectedMessage != ex.what())
+                    {
+                        failThrowsMessage(typeid(ExceptionT), expectedMessage);
+                    }
+                    return;
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failThrowsOther(typeid(ExceptionT));
+                }
+                failThrowsNothing(typeid(ExceptionT));
+            }
+
+            // Like verifyThrows but types derived from ExceptionT do not match. The type comparison only runs
+            // after the catch clause has already matched.
+            template <typename ExceptionT, typename CallableT>
+            void verifyThrowsExactly (CallableT callable)
+            {
+#if !defined(__GNUC__)
+                static_assert(std::is_polymorphic<ExceptionT>::value,
+                              "verifyThrowsExactly can only tell derived types apart when ExceptionT is polymorphic.");
+#endif
+                try
+                {
+                    callable();
+                }
+                catch (const ExceptionT & ex)
+                {
+                    rethrowIfFailed();
+                    if (!currentExceptionIsExactly(typeid(ExceptionT), typeid(ex)))
+                    {
+                        failThrowsOther(typeid(ExceptionT));
+                    }
+                    return;
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failThrowsOther(typeid(ExceptionT));
+                }
+                failThrowsNothing(typeid(ExceptionT));
+            }
+
+            template <typename CallableT>
+            void verifyNoThrow (CallableT callable)
+            {
+                try
+                {
+                    callable();
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failNoThrow();
+                }
+            }
+
+        protected:
+            ScenarioBase (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
+            : mCategoryFullName(categoryFullName), mDescription(scenarioDescription), mExceptionExpected(exceptionExpected)
+            { }
+
+            ScenarioBase (const ScenarioBase & src)
+            : mCategoryFullName(src.mCategoryFullName), mDescription(src.mDescription), mExceptionExpected(src.mExceptionExpected)
+            { }
+
+            // Throws the failure for verifySame. Kept out of line so the template does not need the exception classes.
+            [[noreturn]] void failSame ();
+
+            // A verify method that already failed throws its own exception, which must not be mistaken for the
+            // exception a scenario expects. Call this from inside a catch clause.
+            void rethrowIfFailed ()
+            {
+                if (!mRunPassed)
+                {
+                    throw;
+                }
+            }
+
+            // Call this from inside a catch clause. The thrown type is compared when the runtime can report it,
+            // because caughtType only names the thrown type when the exception type is polymorphic.
+            static bool currentExceptionIsExactly (const std::type_info & expectedType, const std::type_info & caughtType);
+
+            // The type names are only looked up once verification has already failed.
+            [[noreturn]] void failThrowsNothing (const std::type_info & expectedType);
+
+            // Call these from inside the catch clause so the thrown exception can be described.
+            [[noreturn]] void failThrowsOther (const std::type_info & expectedType);
+
+            [[noreturn]] void failThrowsMessage (const std::type_info & expectedType, const std::string & expectedMessage);
+
+            [[noreturn]] void failNoThrow ();
+
+        private:
+            ScenarioBase & operator = (const ScenarioBase & rhs) = delete;
+
+            std::string mCategoryFullName;
+            std::string mDescription;
+            bool mExceptionExpected;
+            bool mRunPassed;
+        };
+
+        template <typename ExceptionT = std::exception>
+        class Scenario : public ScenarioBase
+        {
+        public:
+            Scenario (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected)
+            : ScenarioBase(categoryFullName, scenarioDescription, exceptionExpected)
+            { }
+
+            virtual ~Scenario ()
+            { }
+
+            // A scenario that expects an exception passes only if its steps throw ExceptionT. Any other exception
+            // is reported as a throws verification failure.
+            virtual void run ()
+            {
+                if (!exceptionExpected())
+                {
+                    ScenarioBase::run();
+                    return;
+                }
+
+                try
+                {
+                    ScenarioBase::run();
+                }
+                catch (const ExceptionT &)
+                {
+                    rethrowIfFailed();
+                    return;
+                }
+                catch (...)
+                {
+                    rethrowIfFailed();
+                    failThrowsOther(typeid(ExceptionT));
+                }
+                failThrowsNothing(typeid(ExceptionT));
+            }
+
+        protected:
+            Scenario (const Scenario & src)
+            : ScenarioBase(src)
+            { }
+
+        private:
+            Scenario & operator = (const Scenario & rhs) = delete;
+        };
+
+        // The default scenario type is instantiated once in the runtime instead of in every scenario file.
+        extern template class Scenario<>;
+
+        // Adds a copy of the scenario to the category named by its categoryFullName.
+        void registerScenario (const ScenarioBase * scenario);
+
+    } // namespace Designer
+
+} // namespace MuddledManaged
+
+#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_FINAL( name, line ) ClassDesigner ## name ## line
+#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_RELAY( name, line ) INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_FINAL( name, line )
+#define INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( name ) INTERNAL_DESIGNER_SCENARIO_CLASS_NAME_RELAY( name, __LINE__ )
+
+#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_FINAL( name, line ) InstanceDesigner ## name ## line
+#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_RELAY( name, line ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_FINAL( name, line )
+#define INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME( name ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME_RELAY( name, __LINE__ )
+
+#define INTERNAL_DESIGNER_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType, preprocExceptionExpected ) class INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) \
+: public Designer::Scenario<preprocExceptionType> \
+{ \
+public: \
+    INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) (const std::string & categoryFullName, const std::string & scenarioDescription, bool exceptionExpected) \
+    : Designer::Scenario<preprocExceptionType>(categoryFullName, scenarioDescription, exceptionExpected) \
+    { \
+        Designer::registerScenario(this); \
+    } \
+    virtual std::shared_ptr<Designer::ScenarioBase> clone () const \
+    { \
+        return std::shared_ptr<Designer::ScenarioBase>(new INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName )(*this)); \
+    } \
+    virtual void runSteps (); \
+protected: \
+    INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) (const INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) & src) \
+    : Designer::Scenario<preprocExceptionType>(src) \
+    { } \
+}; \
+INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName ) INTERNAL_DESIGNER_SCENARIO_INSTANCE_NAME( preprocGroupName )(preprocCategoryName, preprocScenarioDescription, preprocExceptionExpected); \
+void INTERNAL_DESIGNER_SCENARIO_CLASS_NAME( preprocGroupName )::runSteps ()
+
+#define DESIGNER_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription ) INTERNAL_DESIGNER_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, std::exception, false )
+
+// The scenario passes only if its steps throw preprocExceptionType or a type derived from it.
+#define DESIGNER_EXCEPTION_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType ) INTERNAL_DESIGNER_SCENARIO( preprocGroupName, preprocCategoryName, preprocScenarioDescription, preprocExceptionType, true )
+
+#endif // Designer_DesignerScenario_h
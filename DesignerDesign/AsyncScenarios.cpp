@@ -0,0 +1,202 @@
+//
+//  AsyncScenarios.cpp
+//  DesignerDesign
+//
+//  These scenarios cover asynchronous scenarios, events, and the event loop that runs them.
+//
+
+#include "../Designer/Designer.h"
+
+#ifdef DESIGNER_COROUTINES_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "StepsScenario.h"
+
+using namespace MuddledManaged;
+
+namespace
+{
+    typedef DesignerDesign::AsyncStepsScenario<> AsyncSteps;
+    typedef DesignerDesign::AsyncStepsScenario<std::out_of_range> AsyncOutOfRangeSteps;
+
+    Designer::AsyncEvent scenarioAsyncEvent;
+}
+
+DESIGNER_ASYNC_SCENARIO( Async, "Async/Timers", "Async scenario resumes after its timer expires." )
+{
+    auto begin = std::chrono::steady_clock::now();
+    co_await sleepFor(std::chrono::milliseconds(20));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    verifyTrue(elapsed >= std::chrono::milliseconds(20));
+}
+
+DESIGNER_ASYNC_SCENARIO( Async, "Async/Events", "Async scenario waits for an event set by another scenario." )
+{
+    co_await waitFor(scenarioAsyncEvent);
+    verifyTrue(scenarioAsyncEvent.isSet());
+}
+
+DESIGNER_ASYNC_SCENARIO( Async, "Async/Events", "Async scenario sets an event that another scenario waits for." )
+{
+    co_await sleepFor(std::chrono::milliseconds(5));
+    scenarioAsyncEvent.set();
+    co_await yield();
+    verifyTrue(scenarioAsyncEvent.isSet());
+}
+
+DESIGNER_SCENARIO( Async, "Async/Executor", "Event loop completes scenarios on several threads." )
+{
+    std::atomic<int> count(0);
+    std::vector<std::shared_ptr<AsyncSteps>> scenarios;
+    for (int i = 0; i < 32; ++i)
+    {
+        scenarios.push_back(std::make_shared<AsyncSteps>(false, [&count] (AsyncSteps & steps) -> Designer::ScenarioTask
+        {
+            co_await steps.sleepFor(std::chrono::milliseconds(5));
+            co_await steps.yield();
+            ++count;
+        }));
+    }
+
+    Designer::EventLoop eventLoop(4);
+    for (auto & scenario : scenarios)
+    {
+        scenario->start(eventLoop);
+    }
+    eventLoop.run();
+    for (auto & scenario : scenarios)
+    {
+        scenario->finish();
+    }
+    verifyEqual(32, count.load());
+}
+
+DESIGNER_SCENARIO( Async, "Async/Executor", "Category run resolves events shared between child categories." )
+{
+    auto scenarioManager = Designer::ScenarioManager::instance();
+    unsigned int threadCount = scenarioManager->asyncThreadCount();
+    scenarioManager->setAsyncThreadCount(2);
+
+    Designer::AsyncEvent event;
+    AsyncSteps waitingScenario(false, [&event] (AsyncSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.waitFor(event);
+    });
+    AsyncSteps settingScenario(false, [&event] (AsyncSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.sleepFor(std::chrono::milliseconds(5));
+        event.set();
+    });
+    auto category = std::make_shared<Designer::Category>("Local", "Local");
+    category->registerCategory("Waiting")->registerScenario(&waitingScenario);
+    category->registerCategory("Setting")->registerScenario(&settingScenario);
+
+    std::ostringstream output;
+    category->run(output);
+    scenarioManager->setAsyncThreadCount(threadCount);
+
+    verifyEqual(2, category->passCount());
+    verifyEqual(0, category->failCount());
+}
+
+DESIGNER_SCENARIO( Async, "Async/Executor", "Scenario left waiting fails as incomplete and ignores a later event." )
+{
+    Designer::AsyncEvent event;
+    AsyncSteps scenario(false, [&event] (AsyncSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.waitFor(event);
+    });
+
+    Designer::EventLoop eventLoop;
+    scenario.start(eventLoop);
+    eventLoop.run();
+    bool incomplete = false;
+    try
+    {
+        scenario.finish();
+    }
+    catch (const Designer::IncompleteScenarioException &)
+    {
+        incomplete = true;
+    }
+    verifyTrue(incomplete);
+
+    auto category = std::make_shared<Designer::Category>("Local", "Local");
+    category->registerScenario(&scenario);
+    std::ostringstream output;
+    category->run(output);
+    verifyEqual(1, category->failCount());
+    verifyTrue(output.str().find("did not complete") != std::string::npos);
+
+    // Both waits above were abandoned, so setting the event now must not resume either of them.
+    event.set();
+    verifyTrue(event.isSet());
+}
+
+DESIGNER_ASYNC_EXCEPTION_SCENARIO( Async, "Async/Exceptions", "Async exception scenario passes when its steps throw the expected type.", std::logic_error )
+{
+    co_await sleepFor(std::chrono::milliseconds(5));
+    throw std::invalid_argument("Argument is not valid.");
+}
+
+DESIGNER_SCENARIO( Async, "Async/Exceptions", "Async exception scenarios are checked when their steps complete." )
+{
+    auto scenarioManager = Designer::ScenarioManager::instance();
+    unsigned int threadCount = scenarioManager->asyncThreadCount();
+    scenarioManager->setAsyncThreadCount(2);
+
+    AsyncOutOfRangeSteps throwingScenario(true, [] (AsyncOutOfRangeSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.sleepFor(std::chrono::milliseconds(5));
+        throw std::out_of_range("Index is out of range.");
+    });
+    AsyncOutOfRangeSteps silentScenario(true, [] (AsyncOutOfRangeSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.yield();
+    });
+    AsyncOutOfRangeSteps unrelatedScenario(true, [] (AsyncOutOfRangeSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.yield();
+        throw std::runtime_error("Unrelated.");
+    });
+    auto category = std::make_shared<Designer::Category>("Local", "Local");
+    category->registerScenario(&throwingScenario);
+    category->registerScenario(&silentScenario);
+    category->registerScenario(&unrelatedScenario);
+
+    std::ostringstream output;
+    category->run(output);
+    scenarioManager->setAsyncThreadCount(threadCount);
+
+    verifyEqual(1, category->passCount());
+    verifyEqual(2, category->failCount());
+    verifyTrue(output.str().find("Actual: no exception") != std::string::npos);
+    verifyTrue(output.str().find("runtime_error with message: Unrelated.") != std::string::npos);
+}
+
+DESIGNER_SCENARIO( Async, "Async/Exceptions", "Async exception scenario run by itself fails when its steps do not throw." )
+{
+    AsyncOutOfRangeSteps scenario(true, [] (AsyncOutOfRangeSteps & steps) -> Designer::ScenarioTask
+    {
+        co_await steps.yield();
+    });
+
+    std::string failure;
+    try
+    {
+        scenario.run();
+    }
+    catch (const Designer::ThrowsVerificationException & ex)
+    {
+        failure = ex.what();
+    }
+    verifyFalse(scenario.passed());
+    verifyTrue(failure.find("out_of_range") != std::string::npos);
+}
+
+#endif // DESIGNER_COROUTINES_ENABLED
@@ -0,0 +1,185 @@
+//
+//  ExceptionScenarios.cpp
+//  DesignerDesign
+//
+//  These scenarios run other scenarios directly to check how expected exceptions fail.
+//
+
+#include <stdexcept>
+
+#include "../Designer/Designer.h"
+#include "StepsScenario.h"
+
+using namespace MuddledManaged;
+
+namespace
+{
+    using DesignerDesign::StepsScenario;
+    
+    typedef StepsScenario<std::exception> Steps;
+    
+    // Runs the scenario and returns the message of the throws verification failure it reports, if any.
+    template <typename ExceptionT>
+    std::string throwsFailure (StepsScenario<ExceptionT> & scenario)
+    {
+        try
+        {
+            scenario.run();
+        }
+        catch (const Designer::ThrowsVerificationException & ex)
+        {
+            return ex.what();
+        }
+        return "";
+    }
+    
+    bool contains (const std::string & text, const std::string & part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+    
+    // Neither type has virtual functions, so typeid of a caught BaseError reference is always BaseError.
+    struct BaseError
+    { };
+    
+    struct DerivedError : BaseError
+    { };
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Exact verification rejects a derived type." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrowsExactly<std::logic_error>([] () { throw std::invalid_argument("Argument is not valid."); });
+    });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "Expected: exception of type"));
+    verifyTrue(contains(failure, "logic_error"));
+    verifyTrue(contains(failure, "invalid_argument"));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Exact verification rejects a derived type that is not polymorphic." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrowsExactly<BaseError>([] () { throw DerivedError(); });
+    });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "BaseError"));
+    verifyTrue(contains(failure, "DerivedError"));
+    
+    Steps exactScenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrowsExactly<BaseError>([] () { throw BaseError(); });
+    });
+    exactScenario.run();
+    verifyTrue(exactScenario.passed());
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Throws verification fails when the message differs." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrows<std::runtime_error>([] () { throw std::runtime_error("Actual."); }, "Expected.");
+    });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "runtime_error with message: Expected."));
+    verifyTrue(contains(failure, "with message: Actual."));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Throws verification fails when nothing is thrown." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrows<std::out_of_range>([] () { });
+    });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "Expected: exception of type"));
+    verifyTrue(contains(failure, "out_of_range"));
+    verifyTrue(contains(failure, "Actual: no exception"));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Exception scenario fails when its steps do not throw." )
+{
+    StepsScenario<std::out_of_range> scenario(true, [] (StepsScenario<std::out_of_range> &) { });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "Expected: exception of type"));
+    verifyTrue(contains(failure, "out_of_range"));
+    verifyTrue(contains(failure, "Actual: no exception"));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Exception scenario fails when its steps throw an unrelated type." )
+{
+    StepsScenario<std::out_of_range> scenario(true, [] (StepsScenario<std::out_of_range> &)
+    {
+        throw std::runtime_error("Unrelated.");
+    });
+    std::string failure = throwsFailure(scenario);
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "Expected: exception of type"));
+    verifyTrue(contains(failure, "out_of_range"));
+    verifyTrue(contains(failure, "runtime_error with message: Unrelated."));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "Failed verification inside the callable is not taken as the expected exception." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyThrows<std::exception>([&steps] () { steps.verifyTrue(false); });
+    });
+    bool boolFailure = false;
+    try
+    {
+        scenario.run();
+    }
+    catch (const Designer::BoolVerificationException &)
+    {
+        boolFailure = true;
+    }
+    verifyTrue(boolFailure);
+    verifyFalse(scenario.passed());
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "No throw verification reports the exception type and message." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyNoThrow([] () { throw std::runtime_error("Unexpected."); });
+    });
+    std::string failure;
+    try
+    {
+        scenario.run();
+    }
+    catch (const Designer::NoThrowVerificationException & ex)
+    {
+        failure = ex.what();
+    }
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "runtime_error with message: Unexpected."));
+}
+
+DESIGNER_SCENARIO( Exception, "Verification/Exceptions/Failures", "No throw verification reports the type of an exception that is not a std::exception." )
+{
+    Steps scenario(false, [] (Steps & steps)
+    {
+        steps.verifyNoThrow([] () { throw DerivedError(); });
+    });
+    std::string failure;
+    try
+    {
+        scenario.run();
+    }
+    catch (const Designer::NoThrowVerificationException & ex)
+    {
+        failure = ex.actualValue();
+    }
+    verifyFalse(scenario.passed());
+    verifyTrue(contains(failure, "exception of type"));
+    verifyTrue(contains(failure, "DerivedError"));
+}
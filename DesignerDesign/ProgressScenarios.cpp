@@ -0,0 +1,124 @@
+//
+//  ProgressScenarios.cpp
+//  DesignerDesign
+//
+//  These scenarios check the results that categories and run progress report while scenarios run.
+//
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "../Designer/Designer.h"
+#include "StepsScenario.h"
+
+using namespace MuddledManaged;
+
+namespace
+{
+    typedef DesignerDesign::StepsScenario<> Steps;
+}
+
+DESIGNER_SCENARIO( Progress, "Progress/Live", "Progress is available while scenarios are still running." )
+{
+    auto scenarioManager = Designer::ScenarioManager::instance();
+    auto progress = scenarioManager->progress().snapshot();
+    
+    int scenarioCount = 0;
+    for (auto category : scenarioManager->categories())
+    {
+        scenarioCount += category->scenarioCount();
+    }
+    verifyEqual(scenarioCount, progress.scenarioCount);
+    verifyTrue(progress.finishedCount() < progress.scenarioCount);
+}
+
+DESIGNER_SCENARIO( Progress, "Progress/Categories", "Parent categories include the results of their children." )
+{
+    Steps passingScenario(false, [] (Steps & steps) { steps.verifyTrue(true); });
+    Steps failingScenario(false, [] (Steps & steps) { steps.verifyTrue(false); });
+    auto top = std::make_shared<Designer::Category>("Top", "Top");
+    auto middle = top->registerCategory("Middle");
+    auto passing = middle->registerCategory("Passing");
+    auto failing = top->registerCategory("Failing");
+    passing->registerScenario(&passingScenario);
+    passing->registerScenario(&passingScenario);
+    middle->registerScenario(&passingScenario);
+    failing->registerScenario(&failingScenario);
+    
+    std::ostringstream output;
+    top->run(output);
+    
+    verifyEqual(2, passing->passCount());
+    verifyEqual(3, middle->passCount());
+    verifyEqual(0, middle->failCount());
+    verifyEqual(1, failing->failCount());
+    verifyEqual(3, top->passCount());
+    verifyEqual(1, top->failCount());
+}
+
+DESIGNER_SCENARIO( Progress, "Progress/Categories", "Running a child category again keeps its parents correct." )
+{
+    Steps passingScenario(false, [] (Steps & steps) { steps.verifyTrue(true); });
+    Steps failingScenario(false, [] (Steps & steps) { steps.verifyTrue(false); });
+    auto top = std::make_shared<Designer::Category>("Top", "Top");
+    auto middle = top->registerCategory("Middle");
+    auto child = middle->registerCategory("Child");
+    child->registerScenario(&passingScenario);
+    child->registerScenario(&failingScenario);
+    middle->registerScenario(&passingScenario);
+    
+    std::ostringstream output;
+    top->run(output);
+    child->run(output);
+    child->run(output);
+    
+    verifyEqual(1, child->passCount());
+    verifyEqual(1, child->failCount());
+    verifyEqual(2, middle->passCount());
+    verifyEqual(1, middle->failCount());
+    verifyEqual(2, top->passCount());
+    verifyEqual(1, top->failCount());
+}
+
+DESIGNER_SCENARIO( Progress, "Progress/Categories", "Results recorded on several threads all reach the top category." )
+{
+    auto top = std::make_shared<Designer::Category>("Top", "Top");
+    auto child = top->registerCategory("Middle")->registerCategory("Child");
+    
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.push_back(std::thread([child, i] ()
+        {
+            for (int j = 0; j < 1000; ++j)
+            {
+                child->recordResult(j % 4 != i);
+            }
+        }));
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    
+    verifyEqual(3000, child->passCount());
+    verifyEqual(1000, child->failCount());
+    verifyEqual(3000, top->passCount());
+    verifyEqual(1000, top->failCount());
+}
+
+DESIGNER_SCENARIO( Progress, "Progress/Status", "Status line reports finished, passed, and failed scenarios." )
+{
+    Designer::RunProgress progress;
+    progress.reset(3);
+    verifyEqual("Finished 0 of 3 scenarios. Passed: 0 Failed: 0", progress.statusLine());
+    
+    progress.recordResult(true);
+    progress.recordResult(false);
+    progress.recordResult(true);
+    verifyEqual("Finished 3 of 3 scenarios. Passed: 2 Failed: 1", progress.statusLine());
+    
+    progress.reset(5);
+    verifyEqual("Finished 0 of 5 scenarios. Passed: 0 Failed: 0", progress.statusLine());
+}
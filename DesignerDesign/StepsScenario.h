@@ -0,0 +1,82 @@
+//
+//  StepsScenario.h
+//  DesignerDesign
+//
+//  Scenarios whose steps are given as a function so that other scenarios can build, run, and check them
+//  directly without registering them with the scenario manager.
+//
+
+#ifndef DesignerDesign_StepsScenario_h
+#define DesignerDesign_StepsScenario_h
+
+#include <exception>
+#include <functional>
+#include <memory>
+
+#include "../Designer/Designer.h"
+
+namespace MuddledManaged
+{
+    namespace DesignerDesign
+    {
+        template <typename ExceptionT = std::exception>
+        class StepsScenario : public Designer::Scenario<ExceptionT>
+        {
+        public:
+            StepsScenario (bool exceptionExpected, std::function<void (StepsScenario &)> steps)
+            : Designer::Scenario<ExceptionT>("Local", "Runs the given steps.", exceptionExpected), mSteps(steps)
+            { }
+
+            virtual std::shared_ptr<Designer::ScenarioBase> clone () const
+            {
+                return std::shared_ptr<Designer::ScenarioBase>(new StepsScenario(*this));
+            }
+
+            virtual void runSteps ()
+            {
+                mSteps(*this);
+            }
+
+        protected:
+            StepsScenario (const StepsScenario & src)
+            : Designer::Scenario<ExceptionT>(src), mSteps(src.mSteps)
+            { }
+
+            std::function<void (StepsScenario &)> mSteps;
+        };
+
+#ifdef DESIGNER_COROUTINES_ENABLED
+        // The steps are a coroutine. Each copy calls its own copy of the function, so anything the function
+        // captures must outlive every copy that runs.
+        template <typename ExceptionT = std::exception>
+        class AsyncStepsScenario : public Designer::AsyncScenario<ExceptionT>
+        {
+        public:
+            AsyncStepsScenario (bool exceptionExpected, std::function<Designer::ScenarioTask (AsyncStepsScenario &)> steps)
+            : Designer::AsyncScenario<ExceptionT>("Local", "Runs the given steps.", exceptionExpected), mSteps(steps)
+            { }
+
+            virtual std::shared_ptr<Designer::ScenarioBase> clone () const
+            {
+                return std::shared_ptr<Designer::ScenarioBase>(new AsyncStepsScenario(*this));
+            }
+
+            virtual Designer::ScenarioTask runStepsAsync ()
+            {
+                return mSteps(*this);
+            }
+
+        protected:
+            AsyncStepsScenario (const AsyncStepsScenario & src)
+            : Designer::AsyncScenario<ExceptionT>(src), mSteps(src.mSteps)
+            { }
+
+            std::function<Designer::ScenarioTask (AsyncStepsScenario &)> mSteps;
+        };
+#endif // DESIGNER_COROUTINES_ENABLED
+
+    } // namespace DesignerDesign
+
+} // namespace MuddledManaged
+
+#endif // DesignerDesign_StepsScenario_h
@@ -0,0 +1,50 @@
+//
+//  VerificationScenarios.cpp
+//  DesignerDesign
+//
+//  These scenarios include only the lightweight scenario header and rely on the Designer runtime library.
+//
+
+#include <stdexcept>
+
+#include "../Designer/DesignerScenario.h"
+
+using namespace MuddledManaged;
+
+DESIGNER_SCENARIO( Verification, "Verification/Types", "Verification supports pointer sameness." )
+{
+    int value = 0;
+    int * pointer = &value;
+    verifySame(&value, pointer);
+}
+
+DESIGNER_SCENARIO( Verification, "Verification/Types", "Verification supports floating point equality." )
+{
+    double expected = 0.5;
+    double actual = 1.0 / 2.0;
+    verifyEqual(expected, actual);
+}
+
+DESIGNER_EXCEPTION_SCENARIO( Verification, "Verification/Exceptions", "Exception scenario passes when it throws the expected type.", std::out_of_range )
+{
+    throw std::out_of_range("Index is past the end.");
+}
+
+DESIGNER_EXCEPTION_SCENARIO( Verification, "Verification/Exceptions", "Exception scenario passes when it throws a derived type.", std::logic_error )
+{
+    throw std::invalid_argument("Argument is not valid.");
+}
+
+DESIGNER_SCENARIO( Verification, "Verification/Exceptions", "Verification supports expected exception types and messages." )
+{
+    verifyThrows<std::logic_error>([] () { throw std::invalid_argument("Argument is not valid."); });
+    verifyThrows<std::runtime_error>([] () { throw std::runtime_error("Failed."); }, "Failed.");
+    verifyThrowsExactly<std::invalid_argument>([] () { throw std::invalid_argument("Argument is not valid."); });
+}
+
+DESIGNER_SCENARIO( Verification, "Verification/Exceptions", "Verification supports code that does not throw." )
+{
+    int value = 0;
+    verifyNoThrow([&value] () { value = 1; });
+    verifyEqual(1, value);
+}
@@ -6,5 +6,4 @@
 //
 
 #define DESIGNER_GENERATE_MAIN
-#define DESIGNER_GENERATE_GLOBALS
 #include "../Designer/Designer.h"